@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "泊松生成器.h"
+
+using namespace 泊松生成器;
+
+namespace {
+
+// 环面 [0, 宽) x [0, 高) 上两点回绕后的最短距离的平方
+float 回绕距离平方(const 点& a, const 点& b, float 宽, float 高) {
+  float dx = std::fabs(a.x - b.x);
+  float dy = std::fabs(a.y - b.y);
+  dx = std::min(dx, 宽 - dx);
+  dy = std::min(dy, 高 - dy);
+  return dx * dx + dy * dy;
+}
+
+// 返回回绕距离小于 最小距离 的点对数；点数少时每对点都可能跨越边界，因此逐对比较
+size_t 违规点对数(const std::vector<点>& 点集, float 最小距离, float 宽, float 高) {
+  // 容许 float 舍入带来的微小误差
+  const float 阈值 = 最小距离 * 最小距离 * 0.9999f;
+  size_t 违规 = 0;
+
+  for (size_t i = 0; i != 点集.size(); i++) {
+    for (size_t j = i + 1; j != 点集.size(); j++) {
+      if (回绕距离平方(点集[i], 点集[j], 宽, 高) < 阈值)
+        违规++;
+    }
+  }
+  return 违规;
+}
+
+} // namespace
+
+int main() {
+  size_t 失败 = 0;
+
+  // 按点数推算半径：点数越少，每个点离接缝越近
+  for (uint32_t n = 1; n <= 14; n++) {
+    for (uint32_t 种子 = 1; 种子 <= 300; 种子++) {
+      DefaultPRNG 随机数生成器(种子);
+      const std::vector<点> 点集 = 生成周期泊松点集(n, 随机数生成器);
+      const float 半径 = 换算泊松规模(n, 矩形(), -1.0f).最小距离;
+      if (违规点对数(点集, 半径, 1.0f, 1.0f)) {
+        std::printf("单位环面: n = %u, 种子 %u 有点对跨越接缝小于最小距离\n", n, 种子);
+        失败++;
+      }
+    }
+  }
+
+  // 显式给出接近环面尺寸一半的大半径
+  for (const float 半径 : {0.3f, 0.4f, 0.5f, 0.6f}) {
+    for (uint32_t 种子 = 1; 种子 <= 300; 种子++) {
+      DefaultPRNG 随机数生成器(种子);
+      const std::vector<点> 点集 = 生成周期泊松点集(100, 随机数生成器, 30, 半径);
+      if (违规点对数(点集, 半径, 1.0f, 1.0f)) {
+        std::printf("单位环面: 半径 %g, 种子 %u 有点对跨越接缝小于最小距离\n", 半径, 种子);
+        失败++;
+      }
+    }
+  }
+
+  // 非单位、非正方形的环面
+  const 矩形 范围{-2.0f, 1.0f, 3.0f, 1.25f};
+  for (uint32_t n = 2; n <= 14; n++) {
+    for (uint32_t 种子 = 1; 种子 <= 100; 种子++) {
+      DefaultPRNG 随机数生成器(种子);
+      std::vector<点> 点集 = 生成周期泊松点集(范围, n, 随机数生成器);
+      const float 半径 = 换算泊松规模(n, 范围, -1.0f).最小距离;
+      for (点& P : 点集) {
+        P.x -= 范围.x;
+        P.y -= 范围.y;
+      }
+      if (违规点对数(点集, 半径, 范围.宽, 范围.高)) {
+        std::printf("矩形环面: n = %u, 种子 %u 有点对跨越接缝小于最小距离\n", n, 种子);
+        失败++;
+      }
+    }
+  }
+
+  std::printf(失败 ? "失败\n" : "通过\n");
+  return 失败 ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+#include <bit>
+#include <cstdio>
+#include <vector>
+
+#include "泊松生成器.h"
+
+using namespace 泊松生成器;
+
+namespace {
+
+bool 逐位相同(const std::vector<点>& 甲, const std::vector<点>& 乙) {
+  if (甲.size() != 乙.size())
+    return false;
+  for (size_t i = 0; i != 甲.size(); i++) {
+    if (std::bit_cast<uint32_t>(甲[i].x) != std::bit_cast<uint32_t>(乙[i].x) ||
+        std::bit_cast<uint32_t>(甲[i].y) != std::bit_cast<uint32_t>(乙[i].y))
+      return false;
+  }
+  return true;
+}
+
+// 用同一个种子在每个线程数下运行 生成，输出都应与单线程逐位相同
+template<typename 生成器>
+bool 检查(const char* 名称, 生成器 生成) {
+  const uint32_t 线程数集[] = {1, 2, 3, 8, 64};
+  const std::vector<点> 基准 = 生成(线程数集[0]);
+
+  if (基准.empty()) {
+    std::printf("%s: 没有生成任何点\n", 名称);
+    return false;
+  }
+  for (const uint32_t 线程数 : 线程数集) {
+    if (!逐位相同(生成(线程数), 基准)) {
+      std::printf("%s: %u 个线程的输出与单线程不同\n", 名称, 线程数);
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main() {
+  bool 通过 = true;
+
+  for (const uint32_t 种子 : {1u, 12345u}) {
+    通过 &= 检查("单位圆", [&](uint32_t 线程数) {
+      DefaultPRNG 随机数生成器(种子);
+      return 生成并行泊松点集(4000, 随机数生成器, true, 30, -1.0f, 线程数);
+    });
+    通过 &= 检查("单位正方形", [&](uint32_t 线程数) {
+      DefaultPRNG 随机数生成器(种子);
+      return 生成并行泊松点集(4000, 随机数生成器, false, 12, -1.0f, 线程数);
+    });
+    通过 &= 检查("矩形", [&](uint32_t 线程数) {
+      DefaultPRNG 随机数生成器(种子);
+      return 生成并行泊松点集(矩形{-3.0f, 2.0f, 7.0f, 1.5f}, 6000, 随机数生成器, 30, -1.0f, 线程数);
+    });
+    通过 &= 检查("多边形", [&](uint32_t 线程数) {
+      const 点 顶点[] = {点(0.0f, 0.0f), 点(4.0f, 0.5f), 点(1.0f, 3.0f)};
+      const 多边形区域 三角形(顶点);
+      DefaultPRNG 随机数生成器(种子);
+      return 生成并行泊松点集(三角形, 3000, 随机数生成器, 30, -1.0f, 线程数);
+    });
+  }
+
+  std::printf(通过 ? "通过\n" : "失败\n");
+  return 通过 ? 0 : 1;
+}
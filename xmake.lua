@@ -12,3 +12,23 @@ target("泊松分布")
     add_includedirs("include/")
     add_files("src/*.cpp")
     add_packages("raylib")
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+target("验证线程数无关")
+    set_kind("binary")
+    set_default(false)
+    add_includedirs("include/")
+    add_files("test/验证线程数无关.cpp")
+    add_tests("default")
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+target("验证周期最小距离")
+    set_kind("binary")
+    set_default(false)
+    add_includedirs("include/")
+    add_files("test/验证周期最小距离.cpp")
+    add_tests("default")